@@ -25,24 +25,40 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef NU_UNIT_H
 #define NU_UNIT_H
 
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 //------------------------------------------------------------------------------
 // Global variables, constants, etc
 //------------------------------------------------------------------------------
 
 // Version
-#define NU_VERSION "1.0.3"
+#define NU_VERSION "1.2.0"
 
 // Constants
 #define NU_TEST_OUTPUT 't'
 #define NU_SUITE_OUTPUT 's'
 #define NU_SUITE_BUFLEN 128
+#define NU_TEST_BUFLEN 256
+#define NU_ARENA_BLOCKLEN 65536
+#define NU_ARENA_ALIGN 16
+
+// Maximum failures recorded per test in nu_results. Define before including
+// nu_unit.h to override.
+#ifndef NU_MAX_RECORDED_FAILURES
+#define NU_MAX_RECORDED_FAILURES 100
+#endif
 
 // Enum and operator strings for comparison macros
 typedef enum nu_op_e {
@@ -63,15 +79,91 @@ static const char* NU_OPNAMES[6] = {
   ">=",
 };
 
+//------------------------------------------------------------------------------
+// Result model
+//
+// While tests run, nu_unit records a tree of results: suite -> test -> failure.
+// All nodes and strings live in an arena owned by nu_results, so recording is
+// just a pointer bump. Walk nu_results.suites after the run to inspect results.
+//------------------------------------------------------------------------------
+
+// A single failed check or assert, or a call to nu_fail() / nu_abort()
+typedef struct nu_failure_s {
+  struct nu_failure_s* next;
+  const char* file;
+  int line;
+  const char* macro;      // eg: "nu_check_int_eq"
+  const char* expr;       // eg: "five, 10". NULL for nu_fail() / nu_abort().
+  const char* values;     // eg: "5 == 10", or the nu_fail() message. May be NULL.
+} nu_failure_t;
+
+// The result of a single test. At most NU_MAX_RECORDED_FAILURES failures are
+// kept per test; if more occur, truncated is set. num_failures counts them all.
+typedef struct nu_test_result_s {
+  struct nu_test_result_s* next;
+  const char* name;
+  long long num_checks;
+  long long num_asserts;
+  long long num_failures;
+  long long num_not_impl;
+  nu_failure_t* failures;
+  nu_failure_t* last_failure;
+  int num_recorded_failures;
+  bool truncated;
+} nu_test_result_t;
+
+// The result of a test suite. Counters sum those of the suite's own tests, and
+// exclude any suites nested within it. Tests run outside of any suite are
+// collected in a single suite with an empty name.
+typedef struct nu_suite_result_s {
+  struct nu_suite_result_s* next;
+  const char* name;
+  long long num_tests;
+  long long num_failed_tests;
+  long long num_checks;
+  long long num_asserts;
+  long long num_failures;
+  long long num_not_impl;
+  nu_test_result_t* tests;
+  nu_test_result_t* last_test;
+} nu_suite_result_t;
+
+// A block of arena memory. Data follows the header.
+typedef struct nu_arena_block_s {
+  struct nu_arena_block_s* next;
+  size_t size;
+  size_t used;
+} nu_arena_block_t;
+
+// Root of the result tree
+typedef struct nu_results_s {
+  nu_suite_result_t* suites;
+  nu_suite_result_t* last_suite;
+  nu_suite_result_t* cur_suite;
+  nu_suite_result_t* no_suite;
+  nu_test_result_t* cur_test;
+  nu_suite_result_t* cur_test_suite;
+  long long num_suites;
+  long long num_tests;
+  long long num_failed_tests;
+  nu_arena_block_t* arena;
+} nu_results_t;
+
 // Internal counters
-extern int nu_num_checks;
-extern int nu_num_asserts;
-extern int nu_num_failures;
-extern int nu_num_not_impl;
-extern int nu_prev_failures;
-extern int nu_prev_not_impl;
+extern long long nu_num_checks;
+extern long long nu_num_asserts;
+extern long long nu_num_failures;
+extern long long nu_num_not_impl;
+extern long long nu_prev_checks;
+extern long long nu_prev_asserts;
+extern long long nu_prev_failures;
+extern long long nu_prev_not_impl;
+extern nu_results_t nu_results;
 extern char nu_output_level;
 extern char nu_target_suite[NU_SUITE_BUFLEN];
+extern char nu_param_test[NU_TEST_BUFLEN];
+extern size_t nu_param_first;
+extern size_t nu_param_last;
 extern bool nu_use_color;
 extern char* NOCOLOR;
 extern char* RED;
@@ -85,14 +177,20 @@ extern size_t nu_outbuf_free;
 
 // Initialize the test counters. Call this above your main() function.
 #define nu_init() \
-  int nu_num_checks = 0; \
-  int nu_num_asserts = 0; \
-  int nu_num_failures = 0; \
-  int nu_num_not_impl = 0; \
-  int nu_prev_failures = 0; \
-  int nu_prev_not_impl = 0; \
+  long long nu_num_checks = 0; \
+  long long nu_num_asserts = 0; \
+  long long nu_num_failures = 0; \
+  long long nu_num_not_impl = 0; \
+  long long nu_prev_checks = 0; \
+  long long nu_prev_asserts = 0; \
+  long long nu_prev_failures = 0; \
+  long long nu_prev_not_impl = 0; \
+  nu_results_t nu_results = {0}; \
   char nu_output_level = NU_TEST_OUTPUT; \
   char nu_target_suite[NU_SUITE_BUFLEN]; \
+  char nu_param_test[NU_TEST_BUFLEN]; \
+  size_t nu_param_first = 0; \
+  size_t nu_param_last = SIZE_MAX; \
   bool nu_use_color = false; \
   char* NOCOLOR = ""; \
   char* RED     = ""; \
@@ -112,6 +210,8 @@ extern size_t nu_outbuf_free;
 // before and after
 static void _nu_save_counters()
 {
+  nu_prev_checks = nu_num_checks;
+  nu_prev_asserts = nu_num_asserts;
   nu_prev_failures = nu_num_failures;
   nu_prev_not_impl = nu_num_not_impl;
 }
@@ -135,6 +235,156 @@ static void _nu_outbuf_append(const char* format, ...)
   va_end(args);
 }
 
+//------------------------------------------------------------------------------
+// Result recording
+//------------------------------------------------------------------------------
+
+// Allocate memory from the result arena. Memory is zeroed, and is only released
+// by nu_free_results().
+static inline void* _nu_arena_alloc(size_t size)
+{
+  nu_arena_block_t* block = nu_results.arena;
+  size_t header = (sizeof(nu_arena_block_t) + NU_ARENA_ALIGN - 1) & ~(size_t)(NU_ARENA_ALIGN - 1);
+  size = (size + NU_ARENA_ALIGN - 1) & ~(size_t)(NU_ARENA_ALIGN - 1);
+
+  if (!block || block->size - block->used < size) {
+    size_t len = (size > NU_ARENA_BLOCKLEN ? size : NU_ARENA_BLOCKLEN);
+    block = (nu_arena_block_t*)malloc(header + len);
+    if (!block) {
+      fprintf(stderr, "nu_unit: out of memory\n");
+      exit(1);
+    }
+    block->size = len;
+    block->used = 0;
+    block->next = nu_results.arena;
+    nu_results.arena = block;
+  }
+
+  void* ptr = (char*)block + header + block->used;
+  block->used += size;
+  memset(ptr, 0, size);
+  return ptr;
+}
+
+// Format a string into the result arena
+static inline char* _nu_arena_vsprintf(const char* format, va_list args)
+{
+  va_list copy;
+  va_copy(copy, args);
+  int n = vsnprintf(NULL, 0, format, copy);
+  va_end(copy);
+  char* str = (char*)_nu_arena_alloc(n + 1);
+  vsnprintf(str, n + 1, format, args);
+  return str;
+}
+
+static inline char* _nu_arena_sprintf(const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  char* str = _nu_arena_vsprintf(format, args);
+  va_end(args);
+  return str;
+}
+
+// Add a new suite to the result tree
+static inline nu_suite_result_t* _nu_add_suite_result(const char* name)
+{
+  nu_suite_result_t* suite = (nu_suite_result_t*)_nu_arena_alloc(sizeof(nu_suite_result_t));
+  suite->name = _nu_arena_sprintf("%s", name);
+  if (nu_results.last_suite) nu_results.last_suite->next = suite;
+  else nu_results.suites = suite;
+  nu_results.last_suite = suite;
+  ++nu_results.num_suites;
+  return suite;
+}
+
+// Start a new test in the result tree, under the current suite
+static inline void _nu_begin_test_result(const char* name)
+{
+  nu_suite_result_t* suite = nu_results.cur_suite;
+  if (!suite) {
+    if (!nu_results.no_suite) nu_results.no_suite = _nu_add_suite_result("");
+    suite = nu_results.no_suite;
+  }
+  nu_test_result_t* test = (nu_test_result_t*)_nu_arena_alloc(sizeof(nu_test_result_t));
+  test->name = _nu_arena_sprintf("%s", name);
+  if (suite->last_test) suite->last_test->next = test;
+  else suite->tests = test;
+  suite->last_test = test;
+  ++suite->num_tests;
+  ++nu_results.num_tests;
+  nu_results.cur_test = test;
+  nu_results.cur_test_suite = suite;
+}
+
+// Finish the current test, filling in its counters from the global counters
+// and adding them to its suite
+static inline void _nu_end_test_result()
+{
+  nu_test_result_t* test = nu_results.cur_test;
+  nu_suite_result_t* suite = nu_results.cur_test_suite;
+  if (!test) return;
+  test->num_checks   = nu_num_checks   - nu_prev_checks;
+  test->num_asserts  = nu_num_asserts  - nu_prev_asserts;
+  test->num_failures = nu_num_failures - nu_prev_failures;
+  test->num_not_impl = nu_num_not_impl - nu_prev_not_impl;
+  suite->num_checks   += test->num_checks;
+  suite->num_asserts  += test->num_asserts;
+  suite->num_failures += test->num_failures;
+  suite->num_not_impl += test->num_not_impl;
+  if (test->num_failures) {
+    ++suite->num_failed_tests;
+    ++nu_results.num_failed_tests;
+  }
+  nu_results.cur_test = NULL;
+  nu_results.cur_test_suite = NULL;
+}
+
+// Record a failure under the current test. The file, macro and expr strings
+// must outlive the run (eg: string literals). If b_expr is given, the recorded
+// expr is "expr, b_expr", formatted into the arena. The values string is also
+// formatted into the arena; pass a NULL format to omit it.
+static inline void _nu_record_failure(const char* file, int line, const char* macro,
+  const char* expr, const char* b_expr, const char* format, ...)
+{
+  nu_test_result_t* test = nu_results.cur_test;
+  if (!test) return;
+  if (test->num_recorded_failures >= NU_MAX_RECORDED_FAILURES) {
+    test->truncated = true;
+    return;
+  }
+  ++test->num_recorded_failures;
+
+  nu_failure_t* failure = (nu_failure_t*)_nu_arena_alloc(sizeof(nu_failure_t));
+  failure->file = file;
+  failure->line = line;
+  failure->macro = macro;
+  failure->expr = (b_expr ? _nu_arena_sprintf("%s, %s", expr, b_expr) : expr);
+  if (format) {
+    va_list args;
+    va_start(args, format);
+    failure->values = _nu_arena_vsprintf(format, args);
+    va_end(args);
+  }
+
+  if (test->last_failure) test->last_failure->next = failure;
+  else test->failures = failure;
+  test->last_failure = failure;
+}
+
+// Release all memory held by the result tree
+static inline void nu_free_results()
+{
+  nu_arena_block_t* block = nu_results.arena;
+  while (block) {
+    nu_arena_block_t* next = block->next;
+    free(block);
+    block = next;
+  }
+  memset(&nu_results, 0, sizeof(nu_results));
+}
+
 //------------------------------------------------------------------------------
 // Testing macros
 //------------------------------------------------------------------------------
@@ -153,6 +403,7 @@ static void _nu_outbuf_append(const char* format, ...)
 #define nu_fail(msg) \
   do { \
     _nu_outbuf_append("%s%s- %s%s\n", nu_msg_indent, RED, msg, NOCOLOR); \
+    _nu_record_failure(__FILE__, __LINE__, "nu_fail", NULL, NULL, "%s", msg); \
     ++nu_num_failures; \
   } while(0)
 
@@ -163,6 +414,7 @@ static void _nu_outbuf_append(const char* format, ...)
 #define nu_abort(msg) \
   do { \
     _nu_outbuf_append("%s%s- %s%s\n", nu_msg_indent, RED, msg, NOCOLOR); \
+    _nu_record_failure(__FILE__, __LINE__, "nu_abort", NULL, NULL, "%s", msg); \
     ++nu_num_failures; \
     return; \
   } while(0)
@@ -175,6 +427,7 @@ static void _nu_outbuf_append(const char* format, ...)
     if(!(expr)) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check(%s) failed%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #expr, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check", #expr, NULL, NULL); \
       ++nu_num_failures; \
     } \
   } while(0)
@@ -188,6 +441,7 @@ static void _nu_outbuf_append(const char* format, ...)
     if(!(expr)) { \
       _nu_outbuf_append("%s%s- %s:%i nu_assert(%s) failed%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #expr, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_assert", #expr, NULL, NULL); \
       ++nu_num_failures; \
       return; \
     } \
@@ -201,6 +455,7 @@ static void _nu_outbuf_append(const char* format, ...)
     if(!(expr)) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check_true(%s) failed%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #expr, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check_true", #expr, NULL, NULL); \
       ++nu_num_failures; \
     } \
   } while(0)
@@ -213,6 +468,7 @@ static void _nu_outbuf_append(const char* format, ...)
     if((expr)) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check_false(%s) failed%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #expr, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check_false", #expr, NULL, NULL); \
       ++nu_num_failures; \
     } \
   } while(0)
@@ -225,6 +481,7 @@ static void _nu_outbuf_append(const char* format, ...)
     if((expr) != NULL) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check_null(%s) failed%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #expr, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check_null", #expr, NULL, NULL); \
       ++nu_num_failures; \
     } \
   } while(0)
@@ -237,11 +494,12 @@ static void _nu_outbuf_append(const char* format, ...)
     if((expr) == NULL) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check_not_null(%s) failed%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #expr, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check_not_null", #expr, NULL, NULL); \
       ++nu_num_failures; \
     } \
   } while(0)
 
-static inline void _nu_check_int_helper(char* macro, int a, char* a_name, int b, char* b_name,
+static inline void _nu_check_int_helper(char* macro, long long a, char* a_name, long long b, char* b_name,
   nu_op_t op, char* file, int line)
 {
   ++nu_num_checks;
@@ -258,8 +516,10 @@ static inline void _nu_check_int_helper(char* macro, int a, char* a_name, int b,
 
   if (!status) {
     ++nu_num_failures;
-    _nu_outbuf_append("%s%s- %s:%i %s(%s, %s) failed: (%d %s %d) is false%s\n",
+    _nu_outbuf_append("%s%s- %s:%i %s(%s, %s) failed: (%lld %s %lld) is false%s\n",
       nu_msg_indent, RED, file, line, macro, a_name, b_name, a, NU_OPNAMES[op], b, NOCOLOR);
+    _nu_record_failure(file, line, macro, a_name, b_name,
+      "%lld %s %lld", a, NU_OPNAMES[op], b);
   }
 }
 
@@ -301,6 +561,8 @@ static inline void _nu_check_flt_helper(char* macro, float a, char* a_name, floa
     ++nu_num_failures;
     _nu_outbuf_append("%s%s- %s:%i %s(%s, %s) failed: (%f %s %f) is false%s\n",
       nu_msg_indent, RED, file, line, macro, a_name, b_name, a, NU_OPNAMES[op], b, NOCOLOR);
+    _nu_record_failure(file, line, macro, a_name, b_name,
+      "%f %s %f", a, NU_OPNAMES[op], b);
   }
 }
 
@@ -328,6 +590,8 @@ static inline void _nu_check_flt_helper(char* macro, float a, char* a_name, floa
     if(strcmp(a,b)) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check_str_eq(%s, %s) failed: (\"%s\" == \"%s\") is false%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #a, #b, a, b, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check_str_eq", #a, #b, \
+        "\"%s\" == \"%s\"", a, b); \
       ++nu_num_failures; \
     } \
   } while(0)
@@ -338,6 +602,8 @@ static inline void _nu_check_flt_helper(char* macro, float a, char* a_name, floa
     if(!strcmp(a,b)) { \
       _nu_outbuf_append("%s%s- %s:%i nu_check_str_ne(%s, %s) failed: (\"%s\" != \"%s\") is false%s\n", \
         nu_msg_indent, RED, __FILE__, __LINE__, #a, #b, a, b, NOCOLOR); \
+      _nu_record_failure(__FILE__, __LINE__, "nu_check_str_ne", #a, #b, \
+        "\"%s\" != \"%s\"", a, b); \
       ++nu_num_failures; \
     } \
   } while(0)
@@ -355,24 +621,84 @@ typedef void (*funcptr)(void);
     nu_run_test_named(func, #func); \
   } while(0)
 
-static void nu_run_test_named(funcptr func, char* name)
+// Prepare to run a test: reset the output buffer and save the counters
+static inline void _nu_begin_test(const char* name)
 {
-  // Reset the output buffer
   memset(nu_outbuf, 0, sizeof(nu_outbuf));
   nu_outbuf_ptr = nu_outbuf;
   nu_outbuf_free = sizeof(nu_outbuf);
-
-  // Run test and figure out the status color
   _nu_save_counters();
-  func();
+  _nu_begin_test_result(name);
+}
+
+// Finish running a test and print its output. If name_failures is set, the
+// test name is printed for failed tests even at suite-level output.
+static inline void _nu_end_test(const char* name, bool name_failures)
+{
+  _nu_end_test_result();
   char* color = _nu_test_status_color();
+  bool failed = (nu_num_failures > nu_prev_failures);
 
   // Print colorized output
-  if(nu_output_level == NU_TEST_OUTPUT)
+  if(nu_output_level == NU_TEST_OUTPUT || (name_failures && failed))
     printf("%s%stest: %s%s\n", nu_test_indent, color, name, NOCOLOR);
   printf("%s", nu_outbuf);
 }
 
+static void nu_run_test_named(funcptr func, char* name)
+{
+  _nu_begin_test(name);
+  func();
+  _nu_end_test(name, false);
+}
+
+// Pointer to a parameterized test w signature: void func(const void* param);
+typedef void (*nu_param_funcptr)(const void*);
+
+// Pointer to a function that names a parameter row, for output
+typedef const char* (*nu_param_namefn)(const void*);
+
+// Run a parameterized test once for each row of a table. Each row is its own
+// test, named "func[index]".
+#define nu_run_test_params(func, table, count) \
+  do { \
+    nu_run_test_params_named(func, #func, table, sizeof(*(table)), count, NULL); \
+  } while(0)
+
+// Same as nu_run_test_params(), but name each row "func[index] <namefn(row)>"
+#define nu_run_test_params_with_names(func, table, count, namefn) \
+  do { \
+    nu_run_test_params_named(func, #func, table, sizeof(*(table)), count, namefn); \
+  } while(0)
+
+static inline void nu_run_test_params_named(nu_param_funcptr func, char* name,
+  const void* table, size_t row_size, size_t count, nu_param_namefn namefn)
+{
+  char row_name[NU_TEST_BUFLEN];
+  size_t last = (nu_param_last < count ? nu_param_last + 1 : count);
+
+  // If '-p' names a test, skip every other parameterized test
+  if (*nu_param_test && strcmp(nu_param_test, name)) return;
+
+  // Say so if '-p' selects no rows of this table, rather than silently passing
+  bool selected = (nu_param_first > 0 || nu_param_last != SIZE_MAX);
+  if (selected && nu_param_first >= count) {
+    printf("%s%s- %s: no rows selected by -p (table has %zu rows)%s\n",
+      nu_test_indent, YELLOW, name, count, NOCOLOR);
+  }
+
+  for (size_t i = nu_param_first; i < last; ++i) {
+    const void* row = (const char*)table + i * row_size;
+    if (namefn) snprintf(row_name, sizeof(row_name), "%s[%zu] %s", name, i, namefn(row));
+    else snprintf(row_name, sizeof(row_name), "%s[%zu]", name, i);
+
+    // Always name failed rows, so a single row can be rerun with '-p'
+    _nu_begin_test(row_name);
+    func(row);
+    _nu_end_test(row_name, true);
+  }
+}
+
 // Run a test suite
 #define nu_run_suite(func) \
   do { \
@@ -383,18 +709,164 @@ static void nu_run_suite_named(funcptr func, char* name)
 {
   if(!*nu_target_suite || !strcmp(nu_target_suite, name)) {
     printf("suite: %s\n", name);
+    // Suites may be nested, so restore the outer suite afterwards
+    nu_suite_result_t* outer = nu_results.cur_suite;
+    nu_results.cur_suite = _nu_add_suite_result(name);
     func();
+    nu_results.cur_suite = outer;
     if(nu_output_level == NU_TEST_OUTPUT) printf("\n");
   }
 }
 
+//------------------------------------------------------------------------------
+// Datasets for parameterized tests
+//------------------------------------------------------------------------------
+
+// A line of a line-based dataset. Points into the mapped file, and is not
+// null-terminated. The line ending is excluded.
+typedef struct nu_line_s {
+  const char* str;
+  size_t len;
+} nu_line_t;
+
+// A read-only, memory-mapped file of parameter rows. Rows are either fixed-size
+// binary records within the file, or nu_line_t entries indexing its lines.
+typedef struct nu_dataset_s {
+  const char* data;
+  size_t size;
+  const void* rows;
+  size_t row_size;
+  size_t count;
+  nu_line_t* lines;
+} nu_dataset_t;
+
+// Run a parameterized test once for each row of a dataset
+#define nu_run_test_dataset(func, dataset) \
+  do { \
+    nu_run_test_params_named(func, #func, (dataset)->rows, (dataset)->row_size, \
+      (dataset)->count, NULL); \
+  } while(0)
+
+// Map a file into memory. Print an error and return false on failure.
+static inline bool _nu_dataset_map(nu_dataset_t* ds, const char* path)
+{
+  memset(ds, 0, sizeof(*ds));
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "Cannot open dataset '%s': %s\n", path, strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    fprintf(stderr, "Cannot stat dataset '%s': %s\n", path, strerror(errno));
+    close(fd);
+    return false;
+  }
+  if (!S_ISREG(st.st_mode)) {
+    fprintf(stderr, "Dataset '%s' is not a regular file\n", path);
+    close(fd);
+    return false;
+  }
+
+  // mmap() rejects empty mappings, so leave an empty file unmapped
+  if (st.st_size > 0) {
+    void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      fprintf(stderr, "Cannot map dataset '%s': %s\n", path, strerror(errno));
+      close(fd);
+      return false;
+    }
+    ds->data = (const char*)data;
+    ds->size = st.st_size;
+  }
+
+  close(fd);
+  return true;
+}
+
+// Release a dataset opened by nu_dataset_open_binary() or nu_dataset_open_lines()
+static inline void nu_dataset_close(nu_dataset_t* ds)
+{
+  if (ds->data) munmap((void*)ds->data, ds->size);
+  free(ds->lines);
+  memset(ds, 0, sizeof(*ds));
+}
+
+// Open a file of fixed-size binary records. Rows point directly into the
+// mapped file. Print an error and return false on failure.
+static inline bool nu_dataset_open_binary(nu_dataset_t* ds, const char* path, size_t record_size)
+{
+  if (!record_size) {
+    fprintf(stderr, "Dataset '%s' needs a non-zero record size\n", path);
+    return false;
+  }
+  if (!_nu_dataset_map(ds, path)) return false;
+  if (ds->size % record_size) {
+    fprintf(stderr, "Dataset '%s' size %zu is not a multiple of record size %zu\n",
+      path, ds->size, record_size);
+    nu_dataset_close(ds);
+    return false;
+  }
+  ds->rows = ds->data;
+  ds->row_size = record_size;
+  ds->count = ds->size / record_size;
+  return true;
+}
+
+// Open a line-based file. Each row is a nu_line_t pointing into the mapped
+// file, so row N is line N+1. Print an error and return false on failure.
+static inline bool nu_dataset_open_lines(nu_dataset_t* ds, const char* path)
+{
+  if (!_nu_dataset_map(ds, path)) return false;
+  if (!ds->size) return true;
+
+  // Count lines. A final line without a trailing newline still counts.
+  const char* end = ds->data + ds->size;
+  size_t count = 0;
+  for (const char* p = ds->data; p < end; ++count) {
+    const char* nl = (const char*)memchr(p, '\n', end - p);
+    p = (nl ? nl + 1 : end);
+  }
+
+  if (count) {
+    ds->lines = (nu_line_t*)malloc(count * sizeof(nu_line_t));
+    if (!ds->lines) {
+      fprintf(stderr, "nu_unit: out of memory\n");
+      exit(1);
+    }
+  }
+
+  // Index lines, excluding "\n" or "\r\n" line endings
+  const char* p = ds->data;
+  for (size_t i = 0; i < count; ++i) {
+    const char* nl = (const char*)memchr(p, '\n', end - p);
+    const char* eol = (nl ? nl : end);
+    size_t len = eol - p;
+    if (len && p[len - 1] == '\r') --len;
+    ds->lines[i].str = p;
+    ds->lines[i].len = len;
+    p = (nl ? nl + 1 : end);
+  }
+
+  ds->rows = ds->lines;
+  ds->row_size = sizeof(nu_line_t);
+  ds->count = count;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Summary, exit and command-line parsing
+//------------------------------------------------------------------------------
+
 // Print a summary of the testing events
 void nu_print_summary()
 {
   int failure = (nu_num_failures || (!nu_num_checks && !nu_num_asserts));
   char* color = (failure ? RED : GREEN);
   char* status = (failure ? "FAILURE" : "SUCCESS");
-  printf("%i checks, %i asserts, %i failures, %i not implemented\n", \
+  printf("%lld checks, %lld asserts, %lld failures, %lld not implemented\n", \
     nu_num_checks, nu_num_asserts, nu_num_failures, nu_num_not_impl);
   printf("%s%s%s\n", color, status, NOCOLOR);
 }
@@ -415,19 +887,63 @@ static void nu_print_usage(const char* program)
     "OPTIONS:\n"
     "  -l <level>   Output level. Accepts: 't', 's', 'test', 'suite'.\n"
     "  -s <suite>   Test suite to run. By default, all suites are run.\n"
+    "  -p <rows>    Parameter rows to run, eg: '42', '10-20' or '10-'.\n"
+    "               Rows apply to every parameterized test, unless prefixed\n"
+    "               by a test name, eg: 'test_decode:42'. Tests that aren't\n"
+    "               parameterized still run. By default, all rows are run.\n"
     "  -c           Enable colorized output.\n"
     "  -v           Print the nu_unit version and exit.\n"
     "  -h           Show this usage info.\n"
     , program);
 }
 
+// Parse a parameter row range of the form "first", "first-last" or "first-",
+// optionally prefixed by a test name, eg: "test_decode:42". Used by
+// nu_parse_cmdline().
+static void nu_parse_param_range(const char* spec)
+{
+  const char* arg = spec;
+  const char* colon = strchr(spec, ':');
+  if (colon) {
+    if (colon == spec || colon - spec >= NU_TEST_BUFLEN) {
+      fprintf(stderr, "Invalid parameter rows '%s'\n", spec);
+      exit(1);
+    }
+    bzero(nu_param_test, NU_TEST_BUFLEN);
+    snprintf(nu_param_test, NU_TEST_BUFLEN, "%.*s", (int)(colon - spec), spec);
+    arg = colon + 1;
+  }
+
+  char* end = (char*)arg;
+  errno = 0;
+  unsigned long long first = 0;
+  unsigned long long last = 0;
+
+  // strtoull() accepts leading whitespace and signs, so check for digits first
+  if (isdigit((unsigned char)*arg)) first = last = strtoull(arg, &end, 10);
+
+  if (end != arg && *end == '-') {
+    const char* rest = end + 1;
+    if (!*rest) { last = SIZE_MAX; end = (char*)rest; }
+    else if (isdigit((unsigned char)*rest)) last = strtoull(rest, &end, 10);
+  }
+
+  if (end == arg || *end || errno || first > last || last > SIZE_MAX) {
+    fprintf(stderr, "Invalid parameter rows '%s'\n", spec);
+    exit(1);
+  }
+
+  nu_param_first = first;
+  nu_param_last = last;
+}
+
 // Parse command-line args and configure nu_unit
 static void nu_parse_cmdline(int argc, char** argv)
 {
   char c = 0;
   opterr = 0;
 
-  while((c = getopt(argc, argv, "l:s:cvh")) != -1) {
+  while((c = getopt(argc, argv, "l:s:p:cvh")) != -1) {
     switch(c) {
       case 'l':
         if(!strcmp(optarg, "t") || !strcmp(optarg, "test")) {
@@ -445,6 +961,9 @@ static void nu_parse_cmdline(int argc, char** argv)
         bzero(nu_target_suite, NU_SUITE_BUFLEN);
         snprintf(nu_target_suite, NU_SUITE_BUFLEN, "%s", optarg);
         break;
+      case 'p':
+        nu_parse_param_range(optarg);
+        break;
       case 'c':
         nu_use_color = true;
         break;
@@ -457,7 +976,7 @@ static void nu_parse_cmdline(int argc, char** argv)
         exit(0);
         break;
       case '?':
-        if(strchr("ls", optopt)) {
+        if(strchr("lsp", optopt)) {
           fprintf(stderr, "Option -%c requires an argument\n", optopt);
         }
         else {
@@ -108,6 +108,124 @@ void string_comparison_suite() {
   nu_run_test(test_bad_string_comparisons);
 }
 
+//==============================================================================
+// Parameterized tests
+//==============================================================================
+
+typedef struct square_row_s {
+  const char* name;
+  int input;
+  int expected;
+} square_row_t;
+
+static const square_row_t square_table[] = {
+  { "zero",     0,  0 },
+  { "one",      1,  1 },
+  { "negative", -3, 9 },
+  { "wrong",    4,  15 }, // Fails, and is named in the output
+};
+
+void test_square(const void* param) {
+  const square_row_t* row = param;
+  nu_check_int_eq(row->input * row->input, row->expected);
+}
+
+const char* square_row_name(const void* param) {
+  return ((const square_row_t*)param)->name;
+}
+
+void parameterized_suite() {
+  nu_run_test_params(test_square, square_table, 4);
+  nu_run_test_params_with_names(test_square, square_table, 4, square_row_name);
+}
+
+//==============================================================================
+// Datasets
+//==============================================================================
+
+static char lines_path[]   = "/tmp/nu_unit_lines_XXXXXX";
+static char records_path[] = "/tmp/nu_unit_records_XXXXXX";
+static char empty_path[]   = "/tmp/nu_unit_empty_XXXXXX";
+static bool dataset_files_written = false;
+
+// Write a temporary data file, filling in the XXXXXX of its path
+static bool write_data_file(char* path, const void* data, size_t len) {
+  int fd = mkstemp(path);
+  if (fd < 0) return false;
+  bool ok = (write(fd, data, len) == (ssize_t)len);
+  close(fd);
+  return ok;
+}
+
+void test_write_dataset_files() {
+  const char text[] = "one\r\ntwo\n\nlast";
+  const int records[] = { 1, 2, 3 };
+  nu_assert(write_data_file(lines_path, text, sizeof(text) - 1));
+  nu_assert(write_data_file(records_path, records, sizeof(records)));
+  nu_assert(write_data_file(empty_path, "", 0));
+  dataset_files_written = true;
+}
+
+void test_open_lines() {
+  nu_dataset_t ds;
+  nu_assert(nu_dataset_open_lines(&ds, lines_path));
+  nu_check_int_eq(ds.count, 4);
+  nu_check_int_eq(ds.lines[0].len, 3); // "\r\n" is stripped
+  nu_check(!strncmp(ds.lines[0].str, "one", 3));
+  nu_check_int_eq(ds.lines[2].len, 0);
+  nu_check_int_eq(ds.lines[3].len, 4); // Last line has no newline
+  nu_check(!strncmp(ds.lines[3].str, "last", 4));
+  nu_dataset_close(&ds);
+}
+
+void test_open_empty() {
+  nu_dataset_t ds;
+  nu_assert(nu_dataset_open_lines(&ds, empty_path));
+  nu_check_int_eq(ds.count, 0);
+  nu_dataset_close(&ds);
+}
+
+void test_open_bad_record_size() {
+  nu_dataset_t ds;
+  nu_check_false(nu_dataset_open_binary(&ds, records_path, 5)); // Prints an error
+}
+
+void test_line(const void* param) {
+  const nu_line_t* line = param;
+  nu_check_null(memchr(line->str, '\r', line->len));
+  nu_check_null(memchr(line->str, '\n', line->len));
+}
+
+void test_record(const void* param) {
+  const int* value = param;
+  nu_check_int_gt(*value, 0);
+}
+
+void dataset_suite() {
+  // The remaining tests need the dataset files
+  nu_run_test(test_write_dataset_files);
+  if (dataset_files_written) {
+    nu_run_test(test_open_lines);
+    nu_run_test(test_open_empty);
+    nu_run_test(test_open_bad_record_size);
+
+    // Each line and each record is its own test
+    nu_dataset_t ds;
+    if (nu_dataset_open_lines(&ds, lines_path)) {
+      nu_run_test_dataset(test_line, &ds);
+      nu_dataset_close(&ds);
+    }
+    if (nu_dataset_open_binary(&ds, records_path, sizeof(int))) {
+      nu_run_test_dataset(test_record, &ds);
+      nu_dataset_close(&ds);
+    }
+  }
+
+  unlink(lines_path);
+  unlink(records_path);
+  unlink(empty_path);
+}
+
 //==============================================================================
 // Miscellaneous nu functionality
 //==============================================================================
@@ -172,6 +290,60 @@ void misc_nu_methods_suite() {
   nu_run_test(test_nu_check_not_null);
 }
 
+//==============================================================================
+// Result tree
+//==============================================================================
+
+void test_recorded_failures() {
+  nu_check_int_eq(1, 2);        // Fails, and is recorded
+  nu_fail("a recorded message"); // Fails, and is recorded
+}
+
+void test_recorded_pass() {
+  nu_check(1 == 1);
+  nu_assert(1 == 1);
+}
+
+// Inspect the results recorded for the two tests above
+void test_result_tree() {
+  nu_suite_result_t* suite = nu_results.cur_suite;
+  nu_assert(suite != NULL);
+  nu_check_str_eq(suite->name, "result_tree_suite");
+  nu_check_int_eq(suite->num_tests, 3);
+  nu_check_int_eq(suite->num_failed_tests, 1);
+  nu_check_int_eq(suite->num_checks, 2);
+  nu_check_int_eq(suite->num_asserts, 1);
+  nu_check_int_eq(suite->num_failures, 2);
+
+  nu_test_result_t* test = suite->tests;
+  nu_check_str_eq(test->name, "test_recorded_failures");
+  nu_check_int_eq(test->num_checks, 1);
+  nu_check_int_eq(test->num_failures, 2);
+
+  nu_failure_t* failure = test->failures;
+  nu_assert(failure != NULL && failure->next != NULL);
+  nu_check_str_eq(failure->file, __FILE__);
+  nu_check_str_eq(failure->macro, "nu_check_int_eq");
+  nu_check_str_eq(failure->expr, "1, 2");
+  nu_check_str_eq(failure->values, "1 == 2");
+  nu_check_str_eq(failure->next->macro, "nu_fail");
+  nu_check_null(failure->next->expr);
+  nu_check_str_eq(failure->next->values, "a recorded message");
+
+  test = test->next;
+  nu_check_str_eq(test->name, "test_recorded_pass");
+  nu_check_int_eq(test->num_checks, 1);
+  nu_check_int_eq(test->num_asserts, 1);
+  nu_check_int_eq(test->num_failures, 0);
+  nu_check_null(test->failures);
+}
+
+void result_tree_suite() {
+  nu_run_test(test_recorded_failures);
+  nu_run_test(test_recorded_pass);
+  nu_run_test(test_result_tree);
+}
+
 //==============================================================================
 // Main
 //==============================================================================
@@ -187,10 +359,14 @@ int main(int argc, char **argv) {
   nu_run_suite(int_comparison_suite);
   nu_run_suite(float_comparison_suite);
   nu_run_suite(string_comparison_suite);
+  nu_run_suite(parameterized_suite);
+  nu_run_suite(dataset_suite);
   nu_run_suite(misc_nu_methods_suite);
+  nu_run_suite(result_tree_suite);
   // add more test suites here...
 
   // Print results and return
   nu_print_summary();
+  nu_free_results();
   nu_exit();
 }